@@ -0,0 +1,183 @@
+// Compile-time alphabet policies shared by the suffix tree builders (Naive, Ukkonen and Motif Search)
+// Each policy maps a character to a child index through a constexpr lookup table,
+// and the child storage of a node is chosen from the alphabet size:
+// dense arrays for small alphabets, sorted sparse lists for large ones.
+
+#ifndef ALPHABET_H
+#define ALPHABET_H
+
+// The constexpr tables and inline static members below need C++17 (g++ -std=c++17, MSVC /std:c++17)
+#if (defined(_MSVC_LANG) && _MSVC_LANG < 201703L) || (!defined(_MSVC_LANG) && __cplusplus < 201703L)
+#error "The suffix tree programs require C++17: compile with -std=c++17"
+#endif
+
+// C++ Libraries
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Alphabets with at most this many symbols store their children in a dense array.
+// 20 keeps DNA (5) and IUPAC (17) dense, while Protein (21) and Byte (256) use sorted lists.
+#define DENSE_CHILDREN_LIMIT 20
+
+
+// Build a lookup table mapping every symbol to its position in the alphabet, -1 for anything else
+template <size_t N>
+constexpr std::array<int, 256> make_index_table(const char (&symbols)[N]) {
+    std::array<int, 256> table{};
+    for (int c = 0; c < 256; c++) table[c] = -1;
+    for (size_t i = 0; i + 1 < N; i++) {
+        table[static_cast<unsigned char>(symbols[i])] = static_cast<int>(i);
+    }
+    return table;
+}
+
+// Build the identity lookup table used by the byte alphabet
+constexpr std::array<int, 256> make_identity_table() {
+    std::array<int, 256> table{};
+    for (int c = 0; c < 256; c++) table[c] = c;
+    return table;
+}
+
+
+// Alphabet policies: name, number of symbols and the char -> index table
+// '$' is part of every alphabet since it terminates the input string
+
+// A, T, G, C, and $ (same order as the original char_to_index)
+struct DNA {
+    static constexpr const char* name = "DNA";
+    static constexpr char symbols[] = "ATGC$";
+    static constexpr int size = sizeof(symbols) - 1;
+    static constexpr std::array<int, 256> index = make_index_table(symbols);
+};
+
+// IUPAC nucleotide codes, including ambiguity codes and U for RNA
+struct IUPAC {
+    static constexpr const char* name = "IUPAC nucleotide";
+    static constexpr char symbols[] = "ACGTURYKMSWBDHVN$";
+    static constexpr int size = sizeof(symbols) - 1;
+    static constexpr std::array<int, 256> index = make_index_table(symbols);
+};
+
+// The 20 standard amino acids
+struct Protein {
+    static constexpr const char* name = "Protein";
+    static constexpr char symbols[] = "ACDEFGHIKLMNPQRSTVWY$";
+    static constexpr int size = sizeof(symbols) - 1;
+    static constexpr std::array<int, 256> index = make_index_table(symbols);
+};
+
+// Any byte, used as a fallback for arbitrary input
+struct Byte {
+    static constexpr const char* name = "Byte";
+    static constexpr int size = 256;
+    static constexpr std::array<int, 256> index = make_identity_table();
+};
+
+
+// Dense child storage: one slot per symbol, T{} marks a missing child
+template <typename T, int N>
+class DenseChildren {
+    std::array<T, N> slots{};
+
+public:
+    T get(int c) const { return slots[c]; }
+
+    void set(int c, T child) { slots[c] = child; }
+
+    bool empty() const {
+        for (int c = 0; c < N; c++) {
+            if (slots[c] != T{}) return false;
+        }
+        return true;
+    }
+
+    // Visit the children in symbol order
+    template <typename F>
+    void for_each(F f) const {
+        for (int c = 0; c < N; c++) {
+            if (slots[c] != T{}) f(c, slots[c]);
+        }
+    }
+
+    // Bytes allocated outside the node itself
+    size_t heap_bytes() const { return 0; }
+};
+
+// Sparse child storage: (symbol, child) pairs kept sorted by symbol
+template <typename T>
+class SparseChildren {
+    std::vector<std::pair<unsigned char, T>> entries;
+
+    static bool less_symbol(const std::pair<unsigned char, T>& entry, int c) { return entry.first < c; }
+
+public:
+    T get(int c) const {
+        auto it = std::lower_bound(entries.begin(), entries.end(), c, less_symbol);
+        return (it != entries.end() && it->first == c) ? it->second : T{};
+    }
+
+    void set(int c, T child) {
+        auto it = std::lower_bound(entries.begin(), entries.end(), c, less_symbol);
+        if (it != entries.end() && it->first == c) {
+            it->second = child;
+        } else {
+            entries.insert(it, std::make_pair(static_cast<unsigned char>(c), child));
+        }
+    }
+
+    bool empty() const { return entries.empty(); }
+
+    // Visit the children in symbol order
+    template <typename F>
+    void for_each(F f) const {
+        for (const auto& entry : entries) f(entry.first, entry.second);
+    }
+
+    // Bytes allocated outside the node itself
+    size_t heap_bytes() const { return entries.capacity() * sizeof(entries[0]); }
+};
+
+// Child storage used by a node of a tree over the given alphabet
+template <typename Alphabet, typename T>
+using Children = typename std::conditional<(Alphabet::size <= DENSE_CHILDREN_LIMIT),
+                                           DenseChildren<T, Alphabet::size>,
+                                           SparseChildren<T>>::type;
+
+
+// Alphabets that can be detected from the input, from the most to the least specific
+enum AlphabetKind { ALPHABET_DNA, ALPHABET_IUPAC, ALPHABET_PROTEIN, ALPHABET_BYTE };
+
+// Check whether every character of the text belongs to the alphabet
+template <typename Alphabet>
+bool fits_alphabet(const char* text) {
+    for (; *text != '\0'; text++) {
+        if (Alphabet::index[static_cast<unsigned char>(*text)] < 0) return false;
+    }
+    return true;
+}
+
+// Pick the smallest alphabet covering the whole input
+inline AlphabetKind detect_alphabet(const char* text) {
+    if (fits_alphabet<DNA>(text)) return ALPHABET_DNA;
+    if (fits_alphabet<IUPAC>(text)) return ALPHABET_IUPAC;
+    if (fits_alphabet<Protein>(text)) return ALPHABET_PROTEIN;
+    return ALPHABET_BYTE;
+}
+
+// Call f with the policy matching the detected alphabet, so the rest of the program
+// runs on code specialized for that alphabet instead of branching per character
+template <typename F>
+auto with_alphabet(AlphabetKind kind, F&& f) -> decltype(f(DNA{})) {
+    switch (kind) {
+        case ALPHABET_DNA: return f(DNA{});
+        case ALPHABET_IUPAC: return f(IUPAC{});
+        case ALPHABET_PROTEIN: return f(Protein{});
+        default: return f(Byte{});
+    }
+}
+
+#endif
@@ -1,6 +1,8 @@
 // Implementing Ukkonen's algorithm to construct a suffix tree and searching for motifs in the suffix tree
 // Time complexity: O(n) for constructing the suffix tree, O(m) for searching for a motif of length m
 // Space complexity: O(n) for the suffix tree
+// Sparse mode indexes only s sampled positions: O(s) space for the tree, plus verification against the text when searching.
+// Its build sorts the sampled suffixes by the text segments between samples: O(n log s) time for every k-th position or word starts
 
 // C++ Libraries
 #include <chrono>  // To measure time taken to construct the suffix tree and motif search
@@ -8,135 +10,526 @@
 #include <iostream>
 #include <fstream>
 #include <string>
+#include <cctype>  // For word boundaries when sampling
+#include <algorithm>
+#include <limits>
+#include "Alphabet.h" // Alphabet policies and child storage
 
 #define INITIAL_SIZE 2048 
 #define GROWTH_FACTOR 2 
-#define ALPHABET_SIZE 5 // A, T, G, C, and $
 
-// Global Variables and Constants
+// Global Constants
 const int oo = 1 << 25;
-int root, last_added, current_position, needSL, r, active_node, active_edge_index, active_length;
 
 using namespace std;
 
 // Node structure to represent a node in the suffix tree
+template <typename Alphabet>
 struct node {
     int start;
     int end;
     int suffix_link;
-    vector<int> nextIndices;
+    Children<Alphabet, int> nextIndices;
 
-    node() : nextIndices(ALPHABET_SIZE, 0), start(0), end(0), suffix_link(0) {}
+    node() : start(0), end(0), suffix_link(0) {}
+};
+
+// Suffix tree built with Ukkonen's algorithm, specialized for one alphabet
+template <typename Alphabet>
+struct SuffixTree {
+    int root, last_added, current_position, needSL, r, active_node, active_edge_index, active_length;
+    vector<node<Alphabet>> tree;
+    string input_string;
+
+    // Function to map a character to its child index, -1 if it is not in the alphabet
+    static int char_to_index(char c) {
+        return Alphabet::index[static_cast<unsigned char>(c)];
+    }
+
+    int edge_length(int node) const {
+        return min(tree[node].end, current_position + 1) - tree[node].start;
+    }
+
+    // Function to initialize a new node
+    int new_node(int start, int end = oo) {
+        node<Alphabet> nd;
+        nd.start = start;
+        nd.end = end;
+        nd.suffix_link = 0;
+        tree.push_back(nd);
+        return ++last_added;
+    }
+
+    char active_edge() const {
+        return input_string[active_edge_index];
+    }
+
+    void add_SL(int node) {
+        if (needSL > 0) tree[needSL].suffix_link = node;
+        needSL = node;
+    }
+
+    bool walk_down(int node) {
+        if (active_length >= edge_length(node)) {
+            active_edge_index += edge_length(node);
+            active_length -= edge_length(node);
+            active_node = node;
+            return true;
+        }
+        return false;
+    }
+
+    void st_init() {
+        needSL = 0;
+        last_added = -1;
+        current_position = -1;
+        r = 0;
+        active_node = 0;
+        active_edge_index = 0;
+        active_length = 0;
+        tree.clear();
+        tree.reserve(2);
+        input_string.clear();
+        root = active_node = new_node(-1, -1);
+    }
+
+    void extend_suffix_tree(char new_char) {
+        input_string += new_char;
+        current_position++;
+        needSL = 0;
+        r++;
+
+        while (r > 0) {
+            if (active_length == 0) {
+                active_edge_index = current_position;
+            }
+
+            int edge_index = char_to_index(active_edge());
+            int next_node = tree[active_node].nextIndices.get(edge_index);
+            if (next_node == 0) {
+                int leaf_node = new_node(current_position);
+                tree[active_node].nextIndices.set(edge_index, leaf_node);
+                add_SL(active_node);
+            } else {
+                if (walk_down(next_node)) continue;
+
+                if (input_string[tree[next_node].start + active_length] == new_char) {
+                    active_length++;
+                    add_SL(active_node);
+                    break;
+                }
+
+                int split_node = new_node(tree[next_node].start, tree[next_node].start + active_length);
+                tree[active_node].nextIndices.set(edge_index, split_node);
+
+                int new_leaf = new_node(current_position);
+                tree[split_node].nextIndices.set(char_to_index(new_char), new_leaf);
+
+                tree[next_node].start += active_length;
+                tree[split_node].nextIndices.set(char_to_index(input_string[tree[next_node].start]), next_node);
+
+                add_SL(split_node);
+            }
+            r--;
+
+            if (active_node == root && active_length > 0) {
+                active_length--;
+                active_edge_index = current_position - r + 1;
+            } else {
+                active_node = (tree[active_node].suffix_link > 0) ? tree[active_node].suffix_link : root;
+            }
+        }
+    }
+
+    // Function to count the number of leaf nodes in a subtree
+    int count_leaf_nodes(int node) const {
+        if (tree[node].nextIndices.empty()) {
+            return 1;
+        }
+
+        int count = 0;
+        tree[node].nextIndices.for_each([&](int, int child) {
+            count += count_leaf_nodes(child);
+        });
+        return count;
+    }
+
+    // Function to search motif and return the number of occurrences
+    int search_motif(const string &motif) const {
+        int current_node = root;
+        int length = motif.length();
+        int index = 0;
+
+        while (index < length) {
+            int edge_index = char_to_index(motif[index]);
+            if (edge_index < 0 || tree[current_node].nextIndices.get(edge_index) == 0) {
+                return 0;
+            }
+
+            current_node = tree[current_node].nextIndices.get(edge_index);
+            int edge_start = tree[current_node].start;
+            int edge_len = edge_length(current_node);
 
-    int edge_length() {
-        return min(end, current_position + 1) - start;
+            for (int j = 0; j < edge_len && index < length; ++j) {
+                if (input_string[edge_start + j] != motif[index]) {
+                    return 0;
+                }
+                index++;
+            }
+        }
+
+        return count_leaf_nodes(current_node);
+    }
+
+    // Function to calculate the space occupied by the suffix tree in bytes
+    size_t calculate_space() const {
+        size_t total_size = 0;
+        for (const auto& nd : tree) {
+            total_size += sizeof(nd.start) + sizeof(nd.end) + sizeof(nd.suffix_link);
+            total_size += sizeof(nd.nextIndices) + nd.nextIndices.heap_bytes();
+        }
+        return total_size;
     }
 };
 
-// Global variables
-vector<node> tree;
-string input_string;
+// Sparse suffix tree: indexes only a sorted sample of suffix start positions, using the same node layout.
+// Each sampled suffix adds one leaf and at most one internal node, so the tree has at most 2 * samples nodes.
+// Occurrences starting between samples are found from the next sample and verified against the text.
+template <typename Alphabet>
+struct SparseSuffixTree {
+    int root;
+    vector<node<Alphabet>> tree;
+    vector<int> samples;  // Sorted sampled positions, always including the terminal character
+    int max_gap;          // Largest distance from a sample to the previous one
+    const string* text;   // Indexed text, not owned
+
+    static int char_to_index(char c) {
+        return Alphabet::index[static_cast<unsigned char>(c)];
+    }
 
-// Function to map 'A', 'T', 'G', 'C', '$' to indices
-int char_to_index(char c) {
-    switch (c) {
-        case 'A': return 0;
-        case 'T': return 1;
-        case 'G': return 2;
-        case 'C': return 3;
-        case '$': return 4;
-        default: return -1;
+    int edge_length(int node) const {
+        return tree[node].end - tree[node].start;
     }
-}
 
-// Function to initialize a new node
-int new_node(int start, int end = oo) {
-    node nd;
-    nd.start = start;
-    nd.end = end;
-    nd.suffix_link = 0;
-    tree.push_back(nd);
-    return ++last_added;
-}
+    int new_node(int start, int end) {
+        node<Alphabet> nd;
+        nd.start = start;
+        nd.end = end;
+        tree.push_back(nd);
+        return tree.size() - 1;
+    }
 
-char active_edge() {
-    return input_string[active_edge_index];
-}
+    // Build the tree over the sampled suffixes of input.
+    // The sampled suffixes are sorted as strings of segments (see build_sorted), which takes O(n log s)
+    // character comparisons for s samples, then the tree is built from that order in O(s).
+    void build(const string &input, vector<int> sampled) {
+        text = &input;
+        int n = input.length();
+        samples = sampled;
+        if (samples.empty() || samples.back() != n - 1) {
+            samples.push_back(n - 1);  // Every position then has a sample at or after it
+        }
 
-void add_SL(int node) {
-    if (needSL > 0) tree[needSL].suffix_link = node;
-    needSL = node;
-}
+        max_gap = 0;
+        for (size_t i = 0; i < samples.size(); ++i) {
+            int prev = (i == 0) ? -1 : samples[i - 1];
+            max_gap = max(max_gap, samples[i] - prev);
+        }
+
+        tree.clear();
+        tree.reserve(2 * samples.size());
+        root = new_node(-1, -1);
+
+        // Only custom sample sets where one segment key is a prefix of another need the slow path;
+        // every k-th position and word starts always sort
+        if (!build_sorted()) {
+            tree.clear();
+            root = new_node(-1, -1);
+            for (int s : samples) {
+                insert_suffix(s);
+            }
+        }
+    }
 
-bool walk_down(int node) {
-    if (active_length >= tree[node].edge_length()) {
-        active_edge_index += tree[node].edge_length();
-        active_length -= tree[node].edge_length();
-        active_node = node;
+    // Length of the key of sample i: its segment [samples[i], samples[i + 1]) plus the next character
+    int key_length(int i) const {
+        return (i + 1 < (int)samples.size()) ? samples[i + 1] - samples[i] + 1 : 1;
+    }
+
+    int compare_keys(int a, int b) const {
+        return text->compare(samples[a], key_length(a), *text, samples[b], key_length(b));
+    }
+
+    // Sort the sampled suffixes and build the tree from their order and LCPs.
+    // The text between two consecutive samples is one segment, so each sampled suffix is a string of
+    // segments ending with the terminal "$". Segments are ranked by their key (the segment plus the
+    // first character of the next one): two keys that differ before either ends differ at a character of
+    // both suffixes, and equal keys are identical, aligned segments. Comparing suffixes segment by segment
+    // then gives the same order as comparing characters. If a key is a proper prefix of another the order
+    // is not decided by the keys, and false is returned without touching the tree.
+    bool build_sorted() {
+        const string &t = *text;
+        int n = t.length();
+        int count = samples.size();
+
+        // Sort and rank the segment keys
+        vector<int> sa(count), tmp(count), rank(count), key_rank(count);
+        for (int i = 0; i < count; ++i) sa[i] = i;
+        sort(sa.begin(), sa.end(), [this](int a, int b) { return compare_keys(a, b) < 0; });
+
+        int classes = 1;
+        key_rank[sa[0]] = 0;
+        for (int i = 1; i < count; ++i) {
+            int a = sa[i - 1], b = sa[i];
+            if (compare_keys(a, b) != 0) {
+                if (key_length(a) < key_length(b) && t.compare(samples[a], key_length(a), t, samples[b], key_length(a)) == 0) {
+                    return false;
+                }
+                classes++;
+            }
+            key_rank[b] = classes - 1;
+        }
+        rank = key_rank;
+
+        // Prefix doubling over the segment ranks until every sampled suffix has its own rank
+        vector<int> second(count), bucket;
+        for (int h = 1; classes < count; h <<= 1) {
+            // Order by the rank h segments ahead: suffixes without one come first
+            int k = 0;
+            for (int i = count - h; i < count; ++i) second[k++] = i;
+            for (int i = 0; i < count; ++i) {
+                if (sa[i] >= h) second[k++] = sa[i] - h;
+            }
+
+            // Stable counting sort by the own rank
+            bucket.assign(classes + 1, 0);
+            for (int i = 0; i < count; ++i) bucket[rank[i] + 1]++;
+            for (int b = 1; b <= classes; ++b) bucket[b] += bucket[b - 1];
+            for (int i = 0; i < count; ++i) sa[bucket[rank[second[i]]]++] = second[i];
+
+            tmp[sa[0]] = 0;
+            classes = 1;
+            for (int i = 1; i < count; ++i) {
+                int a = sa[i - 1], b = sa[i];
+                int ra = (a + h < count) ? rank[a + h] : -1;
+                int rb = (b + h < count) ? rank[b + h] : -1;
+                if (rank[a] != rank[b] || ra != rb) classes++;
+                tmp[b] = classes - 1;
+            }
+            rank.swap(tmp);
+        }
+
+        // Character LCP of each sampled suffix with the previous one in sorted order (Kasai on segments).
+        // Equal leading segments are skipped by rank, the rest is compared up to the first difference.
+        vector<int> lcp(count, 0);
+        int h = 0;
+        for (int i = 0; i < count; ++i) {
+            if (rank[i] == 0) {
+                h = 0;
+                continue;
+            }
+            int j = sa[rank[i] - 1];
+            while (i + h < count && j + h < count && key_rank[i + h] == key_rank[j + h]) {
+                h++;
+            }
+            int a = samples[i + h], b = samples[j + h];  // The unique "$" segment keeps both in range
+            int extra = 0;
+            while (a + extra < n && b + extra < n && t[a + extra] == t[b + extra]) {
+                extra++;
+            }
+            lcp[rank[i]] = a - samples[i] + extra;
+            if (h > 0) h--;
+        }
+
+        // Add the suffixes in sorted order, keeping the rightmost path of the tree on a stack
+        vector<pair<int, int>> stack;  // (node, string depth)
+        stack.push_back(make_pair(root, 0));
+        for (int r = 0; r < count; ++r) {
+            int s = samples[sa[r]];
+            int l = lcp[r];
+
+            int last = 0;
+            while (stack.back().second > l) {
+                last = stack.back().first;
+                stack.pop_back();
+            }
+
+            // Split the edge into the last popped node where the suffix branches off
+            if (stack.back().second < l) {
+                int parent = stack.back().first;
+                int edge_start = tree[last].start;
+                int split_node = new_node(edge_start, edge_start + l - stack.back().second);
+                tree[parent].nextIndices.set(char_to_index(t[edge_start]), split_node);
+                tree[last].start = tree[split_node].end;
+                tree[split_node].nextIndices.set(char_to_index(t[tree[last].start]), last);
+                stack.push_back(make_pair(split_node, l));
+            }
+
+            int leaf = new_node(s + l, n);
+            tree[stack.back().first].nextIndices.set(char_to_index(t[s + l]), leaf);
+            stack.push_back(make_pair(leaf, n - s));
+        }
         return true;
     }
-    return false;
-}
 
-void st_init() {
-    needSL = 0;
-    last_added = -1;
-    current_position = -1;
-    r = 0;
-    active_node = 0;
-    active_edge_index = 0;
-    active_length = 0;
-    tree.clear();
-    tree.reserve(2);
-    root = active_node = new_node(-1, -1);
-}
+    // Insert the suffix starting at s, splitting the edge where it leaves the tree
+    void insert_suffix(int s) {
+        const string &t = *text;
+        int n = t.length();
+        int current_node = root;
+        int pos = s;
+
+        while (true) {
+            int edge_index = char_to_index(t[pos]);
+            int child = tree[current_node].nextIndices.get(edge_index);
+            if (child == 0) {
+                tree[current_node].nextIndices.set(edge_index, new_node(pos, n));
+                return;
+            }
 
-void extend_suffix_tree(char new_char) {
-    input_string += new_char;
-    current_position++;
-    needSL = 0;
-    r++;
+            int edge_start = tree[child].start;
+            int edge_len = edge_length(child);
+            int j = 0;
+            while (j < edge_len && t[edge_start + j] == t[pos + j]) {
+                j++;
+            }
+            if (j == edge_len) {
+                current_node = child;
+                pos += j;
+                continue;
+            }
 
-    while (r > 0) {
-        if (active_length == 0) {
-            active_edge_index = current_position;
+            // The terminal character is unique, so the suffix always diverges before the text ends
+            int split_node = new_node(edge_start, edge_start + j);
+            tree[current_node].nextIndices.set(edge_index, split_node);
+            tree[child].start += j;
+            tree[split_node].nextIndices.set(char_to_index(t[edge_start + j]), child);
+            tree[split_node].nextIndices.set(char_to_index(t[pos + j]), new_node(pos + j, n));
+            return;
         }
+    }
 
-        int edge_index = char_to_index(active_edge());
-        if (tree[active_node].nextIndices[edge_index] == 0) {
-            int leaf_node = new_node(current_position);
-            tree[active_node].nextIndices[edge_index] = leaf_node;
-            add_SL(active_node);
-        } else {
-            int next_node = tree[active_node].nextIndices[edge_index];
-            if (walk_down(next_node)) continue;
+    // Distance from sample s to the previous sample (or to the start of the text)
+    int gap_before(int s) const {
+        auto it = lower_bound(samples.begin(), samples.end(), s);
+        return (it == samples.begin()) ? s + 1 : s - *(it - 1);
+    }
 
-            if (input_string[tree[next_node].start + active_length] == new_char) {
-                active_length++;
-                add_SL(active_node);
-                break;
+    // Collect the sampled suffixes that start with motif[from..]
+    void sampled_matches(const string &motif, int from, vector<int> &out) const {
+        const string &t = *text;
+        int n = t.length();
+        int length = motif.length();
+        int current_node = root;
+        int depth = 0;  // String depth of current_node
+        int index = from;
+
+        while (index < length) {
+            int edge_index = char_to_index(motif[index]);
+            if (edge_index < 0 || tree[current_node].nextIndices.get(edge_index) == 0) {
+                return;
             }
 
-            int split_node = new_node(tree[next_node].start, tree[next_node].start + active_length);
-            tree[active_node].nextIndices[edge_index] = split_node;
+            current_node = tree[current_node].nextIndices.get(edge_index);
+            int edge_start = tree[current_node].start;
+            int edge_len = edge_length(current_node);
 
-            int new_leaf = new_node(current_position);
-            tree[split_node].nextIndices[char_to_index(new_char)] = new_leaf;
+            for (int j = 0; j < edge_len && index < length; ++j) {
+                if (t[edge_start + j] != motif[index]) {
+                    return;
+                }
+                index++;
+            }
+            depth += edge_len;
+        }
 
-            tree[next_node].start += active_length;
-            tree[split_node].nextIndices[char_to_index(input_string[tree[next_node].start])] = next_node;
+        // Every leaf below the match is a sampled suffix; a leaf at string depth d starts at n - d
+        vector<pair<int, int>> stack;
+        stack.push_back(make_pair(current_node, depth));
+        while (!stack.empty()) {
+            int nd = stack.back().first;
+            int nd_depth = stack.back().second;
+            stack.pop_back();
+
+            if (tree[nd].nextIndices.empty()) {
+                out.push_back(n - nd_depth);
+                continue;
+            }
+            tree[nd].nextIndices.for_each([&](int, int child) {
+                stack.push_back(make_pair(child, nd_depth + edge_length(child)));
+            });
+        }
+    }
 
-            add_SL(split_node);
+    // Function to search motif and return the number of occurrences.
+    // Cost for a motif of length m and a largest gap g between samples:
+    //   min(m, g) tree walks, each listing every sampled suffix below motif[j..] and checking j characters,
+    //   plus, when m < g, an O(n * m) scan of the gaps for occurrences that fit between two samples.
+    // Dense samples (every k-th position, small k) keep this close to the full tree; very sparse samples
+    // (e.g. word starts in text without separators) turn every query into a scan of the text.
+    int search_motif(const string &motif) const {
+        const string &t = *text;
+        int length = motif.length();
+        int count = 0;
+
+        // An occurrence at p is found from the first sample s >= p: the tree matches motif[j..] at s = p + j,
+        // and the first j characters are checked against the text just before s
+        vector<int> matches;
+        for (int j = 0; j < length && j < max_gap; ++j) {
+            matches.clear();
+            sampled_matches(motif, j, matches);
+            for (int s : matches) {
+                if (j < gap_before(s) && t.compare(s - j, j, motif, 0, j) == 0) {
+                    count++;
+                }
+            }
         }
-        r--;
 
-        if (active_node == root && active_length > 0) {
-            active_length--;
-            active_edge_index = current_position - r + 1;
-        } else {
-            active_node = (tree[active_node].suffix_link > 0) ? tree[active_node].suffix_link : root;
+        // Motifs shorter than a gap can also fit entirely between two samples, so scan those gaps directly
+        if (length < max_gap) {
+            for (size_t i = 0; i < samples.size(); ++i) {
+                int prev = (i == 0) ? -1 : samples[i - 1];
+                for (int p = prev + 1; p + length <= samples[i]; ++p) {
+                    if (t.compare(p, length, motif) == 0) {
+                        count++;
+                    }
+                }
+            }
+        }
+
+        return count;
+    }
+
+    // Function to calculate the space occupied by the sparse suffix tree in bytes
+    size_t calculate_space() const {
+        size_t total_size = samples.capacity() * sizeof(int);
+        for (const auto& nd : tree) {
+            total_size += sizeof(nd.start) + sizeof(nd.end) + sizeof(nd.suffix_link);
+            total_size += sizeof(nd.nextIndices) + nd.nextIndices.heap_bytes();
         }
+        return total_size;
     }
+};
+
+// Sample every k-th position (k = 3 gives the codon frame starting at frame)
+vector<int> frame_samples(int length, int k, int frame) {
+    vector<int> samples;
+    for (int i = frame; i < length; i += k) {
+        samples.push_back(i);
+    }
+    return samples;
+}
+
+// Sample every position that starts a word, i.e. an alphanumeric character not preceded by one
+vector<int> word_start_samples(const string &input) {
+    vector<int> samples;
+    for (size_t i = 0; i < input.length(); ++i) {
+        if (isalnum(static_cast<unsigned char>(input[i])) &&
+            (i == 0 || !isalnum(static_cast<unsigned char>(input[i - 1])))) {
+            samples.push_back(i);
+        }
+    }
+    return samples;
 }
 
 // Function to read the content of the file into a dynamically allocated string
@@ -160,6 +553,11 @@ char* readFile(const char* filename) {
         }
     }
 
+    // Drop the trailing newline editors add
+    while (length > 0 && (buffer[length - 1] == '\n' || buffer[length - 1] == '\r')) {
+        length--;
+    }
+
     buffer[length] = '\0';
     file.close();
 
@@ -170,93 +568,116 @@ char* readFile(const char* filename) {
     return buffer;
 }
 
-// Function to count the number of leaf nodes in a subtree
-int count_leaf_nodes(int node) {
-    if (tree[node].nextIndices[0] == 0 && tree[node].nextIndices[1] == 0 &&
-        tree[node].nextIndices[2] == 0 && tree[node].nextIndices[3] == 0 &&
-        tree[node].nextIndices[4] == 0) {
-        return 1;
-    }
-
-    int count = 0;
-    for (int i = 0; i < ALPHABET_SIZE; ++i) {
-        if (tree[node].nextIndices[i] > 0) {
-            count += count_leaf_nodes(tree[node].nextIndices[i]);
+// Loop to search for motifs until the user enters 'Q'
+template <typename Tree>
+void motif_search_loop(const Tree &st) {
+    string motif;
+    while (true) {
+        cout << "\nEnter the motif to search for (or 'Q' to quit): ";
+        // Stop on 'Q' or when no more input can be read
+        if (!(cin >> motif) || motif == "Q" || motif == "q") {
+            break;
         }
-    }
-    return count;
-}
 
-// Function to search motif and return the number of occurrences
-int search_motif(const string &motif) {
-    int current_node = root;
-    int length = motif.length();
-    int index = 0;
+        // Measure time to search the motif
+        auto start_time = chrono::high_resolution_clock::now();
+
+        int count = st.search_motif(motif);
+
+        auto end_time = chrono::high_resolution_clock::now();
+        auto search_time = chrono::duration_cast<chrono::milliseconds>(end_time - start_time).count();
+        cout << "Time taken to search for the motif: " << search_time << " milliseconds." << endl;
 
-    while (index < length) {
-        int edge_index = char_to_index(motif[index]);
-        if (tree[current_node].nextIndices[edge_index] == 0) {
-            return 0;
+        if (count > 0) {
+            cout << "The motif \"" << motif << "\" is present in the string " << count << " times." << endl;
+        } else {
+            cout << "The motif \"" << motif << "\" is not present in the string." << endl;
         }
+    }
+}
 
-        current_node = tree[current_node].nextIndices[edge_index];
-        int edge_start = tree[current_node].start;
-        int edge_length = tree[current_node].edge_length();
+// Build the suffix tree for one alphabet and answer motif queries until the user quits
+template <typename Alphabet>
+void run_motif_search(const string &input_str) {
+    cout << "Alphabet: " << Alphabet::name << endl;
+
+    // Choose between the full tree and a sparse tree over sampled positions
+    int mode = 1;
+    cout << "Sparse trees (2, 3) use less memory, but searches also scan the text between samples for short motifs." << endl;
+    cout << "Enter 1 to index every position, 2 to index every k-th position, 3 to index word starts: ";
+    if (!(cin >> mode)) {
+        mode = 1;  // Fall back to the full tree on unreadable input
+        cin.clear();
+        cin.ignore(numeric_limits<streamsize>::max(), '\n');
+    }
 
-        for (int j = 0; j < edge_length && index < length; ++j) {
-            if (input_string[edge_start + j] != motif[index]) {
-                return 0;
+    if (mode == 2 || mode == 3) {
+        vector<int> samples;
+        if (mode == 2) {
+            int k = 3;
+            cout << "Enter k (3 for codon frames): ";
+            if (!(cin >> k) || k < 1) {
+                k = 3;  // Fall back to codon frames on unreadable input
+                cin.clear();
+                cin.ignore(numeric_limits<streamsize>::max(), '\n');
             }
-            index++;
+            samples = frame_samples(input_str.length(), k, 0);
+        } else {
+            samples = word_start_samples(input_str);
         }
-    }
 
-    return count_leaf_nodes(current_node);
-}
+        // Measure time to construct the sparse suffix tree
+        SparseSuffixTree<Alphabet> st;
+        auto start_time = chrono::high_resolution_clock::now();
+        st.build(input_str, samples);
+        auto end_time = chrono::high_resolution_clock::now();
+        auto build_time = chrono::duration_cast<chrono::milliseconds>(end_time - start_time).count();
+        cout << "Time taken to build the sparse suffix tree over " << st.samples.size() << " positions: "
+             << build_time << " milliseconds." << endl;
+        cout << "Memory occupied by the sparse suffix tree: " << st.calculate_space() / 1024.0 << " KB" << endl;
+
+        // Warn when samples are so far apart that searches mostly scan the text
+        if (2 * st.max_gap > (int)input_str.length()) {
+            cout << "Warning: the largest gap between samples is " << st.max_gap
+                 << " characters, so most motif searches will scan the text instead of using the tree." << endl;
+        }
 
-// Driver function
-int main() {
-    // Read the input string from the file
-    char* input = readFile("Data.txt");
-    string input_str(input);
+        motif_search_loop(st);
+        return;
+    }
 
     // Measure time to construct the suffix tree
+    SuffixTree<Alphabet> st;
     auto start_time = chrono::high_resolution_clock::now();
     
-    st_init();
+    st.st_init();
     for (char c : input_str) {
-        extend_suffix_tree(c);
+        st.extend_suffix_tree(c);
     }
 
     auto end_time = chrono::high_resolution_clock::now();
     auto build_time = chrono::duration_cast<chrono::milliseconds>(end_time - start_time).count();
     cout << "Time taken to build the suffix tree: " << build_time << " milliseconds." << endl;
+    cout << "Memory occupied by the suffix tree: " << st.calculate_space() / 1024.0 << " KB" << endl;
 
-    // Loop to search for motifs until the user enters 'Q'
-    string motif;
-    while (true) {
-        cout << "\nEnter the motif to search for (or 'Q' to quit): ";
-        cin >> motif;
-
-        if (motif == "Q" || motif == "q") {
-            break;
-        }
-
-        // Measure time to search the motif
-        start_time = chrono::high_resolution_clock::now();
-
-        int count = search_motif(motif);
+    motif_search_loop(st);
+}
 
-        end_time = chrono::high_resolution_clock::now();
-        auto search_time = chrono::duration_cast<chrono::milliseconds>(end_time - start_time).count();
-        cout << "Time taken to search for the motif: " << search_time << " milliseconds." << endl;
+// Driver function
+int main() {
+    // Read the input string from the file
+    char* input = readFile("Data.txt");
+    string input_str(input);
 
-        if (count > 0) {
-            cout << "The motif \"" << motif << "\" is present in the string " << count << " times." << endl;
-        } else {
-            cout << "The motif \"" << motif << "\" is not present in the string." << endl;
-        }
+    // Detect the alphabet once and run the tree code specialized for it
+    AlphabetKind kind = detect_alphabet(input);
+    if (kind == ALPHABET_BYTE) {
+        cout << "Note: the input has characters outside the DNA, IUPAC and protein alphabets, using the byte alphabet." << endl;
     }
+    with_alphabet(kind, [&input_str](auto alphabet) {
+        run_motif_search<decltype(alphabet)>(input_str);
+    });
 
+    free(input);
     return 0;
 }
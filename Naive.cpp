@@ -12,26 +12,26 @@
 #include <cstring>   
 #include <fstream>  
 #include <chrono>   // For measuring time
+#include "Alphabet.h" // Alphabet policies and child storage
+#include "TreeExport.h" // Buffered DOT/JSON/binary export
 
 
-// Constants for buffer size, max character and growth factor
+// Constants for buffer size and growth factor
 #define INITIAL_SIZE 2048 
 #define GROWTH_FACTOR 2   
-#define MAX_CHAR 256 
 
 
-// Suffix Tree Node class
+// Suffix Tree Node class, specialized for the alphabet of the input
+template <typename Alphabet>
 class SuffixTreeNode {
 public:
-    std::vector<SuffixTreeNode*> children; // Array of pointers pointing to child nodes
+    Children<Alphabet, SuffixTreeNode*> children; // Pointers to child nodes, indexed by symbol
     int start;                               // Starting index of the edge
     int* end;                                // End index of the edge
     int suffixIndex;                         // Suffix index (for leaves)
 
     // Constructor to initialize the suffix tree node
-    SuffixTreeNode(int start, int* end) : start(start), end(end), suffixIndex(-1) {
-        children.resize(MAX_CHAR, nullptr); // Initialize children with nullptrs
-    }
+    SuffixTreeNode(int start, int* end) : start(start), end(end), suffixIndex(-1) {}
 };
 
 
@@ -65,6 +65,11 @@ char* readFile(const char* filename) {
         }
     }
 
+    // Drop the trailing newline editors add, it is not part of the sequence
+    while (length > 0 && (buffer[length - 1] == '\n' || buffer[length - 1] == '\r')) {
+        length--;
+    }
+
     buffer[length] = '\0'; // Null-terminate the string
     file.close();
 
@@ -78,25 +83,28 @@ char* readFile(const char* filename) {
 
 
 // Function to build the suffix tree using naive approach
-SuffixTreeNode* buildSuffixTree(char* input) {
+template <typename Alphabet>
+SuffixTreeNode<Alphabet>* buildSuffixTree(char* input) {
     input_string = input; 
     int length = strlen(input_string); 
 
     // Create the root node of the suffix tree
-    SuffixTreeNode* root = new SuffixTreeNode(-1, new int(-1));
+    SuffixTreeNode<Alphabet>* root = new SuffixTreeNode<Alphabet>(-1, new int(-1));
 
     // Loop through all suffixes to build the tree
     for (int i = 0; i < length; i++) {
-        SuffixTreeNode* node = root; // Start from the root node
+        SuffixTreeNode<Alphabet>* node = root; // Start from the root node
         for (int j = i; j < length; j++) {
-            int index = static_cast<unsigned char>(input_string[j]); 
-            if (node->children[index] == nullptr) {
+            int index = Alphabet::index[static_cast<unsigned char>(input_string[j])]; 
+            SuffixTreeNode<Alphabet>* child = node->children.get(index);
+            if (child == nullptr) {
 
                 // Create a new leaf node if no edge exists for this character
-                node->children[index] = new SuffixTreeNode(j, new int(length - 1));
-                node->children[index]->suffixIndex = i; // Store suffix index
+                child = new SuffixTreeNode<Alphabet>(j, new int(length - 1));
+                child->suffixIndex = i; // Store suffix index
+                node->children.set(index, child);
             }
-            node = node->children[index]; // Move to the child node
+            node = child; // Move to the child node
         }
     }
     return root; // Return the root of the suffix tree
@@ -112,7 +120,8 @@ void printEdge(int start, int end) {
 
 
 // Recursive function to print the suffix tree in a structured format
-void printSuffixTree(SuffixTreeNode* node, int level) {
+template <typename Alphabet>
+void printSuffixTree(SuffixTreeNode<Alphabet>* node, int level) {
     if (node == nullptr) return; // Base case for recursion
 
     // If it's not the root node and has a valid start position, print the edge
@@ -123,49 +132,76 @@ void printSuffixTree(SuffixTreeNode* node, int level) {
     }
 
     // Recursively print all children
-    for (size_t i = 0; i < MAX_CHAR; i++) {
-        if (node->children[i] != nullptr) {
-            printSuffixTree(node->children[i], level + 1);
-        }
+    node->children.for_each([level](int, SuffixTreeNode<Alphabet>* child) {
+        printSuffixTree(child, level + 1);
+    });
+}
+
+
+// Export the suffix tree to a file without recursion, writing edges as (start, length) references
+template <typename Alphabet>
+void exportSuffixTree(SuffixTreeNode<Alphabet>* root, ExportFormat format) {
+    const char* filename = export_file_name(format);
+    TreeExporter exporter(filename, format);
+    if (!exporter.is_open()) {
+        std::cerr << "Error opening file." << std::endl; // Error handling
+        return;
+    }
+
+    auto start = std::chrono::high_resolution_clock::now();
+    export_tree(exporter, root,
+        [](SuffixTreeNode<Alphabet>* node, auto visit) {
+            node->children.for_each([&visit](int, SuffixTreeNode<Alphabet>* child) { visit(child); });
+        },
+        [](SuffixTreeNode<Alphabet>* child) {
+            return std::make_pair(child->start, 1); // The naive tree adds one node per character
+        });
+    auto end = std::chrono::high_resolution_clock::now();
+
+    if (!exporter.ok()) {
+        std::cerr << "Error writing file." << std::endl; // Error handling
+        return;
     }
+
+    std::chrono::duration<double, std::milli> cpu_time_used = end - start;
+    std::cout << "Suffix tree exported to " << filename << ": " << exporter.bytes_written() / 1024.0
+              << " KB in " << cpu_time_used.count() << " ms" << std::endl;
 }
 
 
 // Function to calculate the total memory occupied by the suffix tree
-size_t calculateMemoryUsage(SuffixTreeNode* node) {
+template <typename Alphabet>
+size_t calculateMemoryUsage(SuffixTreeNode<Alphabet>* node) {
     if (node == nullptr) return 0; // Base case for recursion
 
-    size_t totalMemory = sizeof(SuffixTreeNode);
-    for (size_t i = 0; i < MAX_CHAR; i++) {
-        totalMemory += calculateMemoryUsage(node->children[i]); 
-    }
+    size_t totalMemory = sizeof(SuffixTreeNode<Alphabet>) + node->children.heap_bytes();
+    node->children.for_each([&totalMemory](int, SuffixTreeNode<Alphabet>* child) {
+        totalMemory += calculateMemoryUsage(child); 
+    });
     return totalMemory; 
 }
 
 
 // Free the suffix tree to prevent memory leaks
-void freeSuffixTree(SuffixTreeNode* node) {
+template <typename Alphabet>
+void freeSuffixTree(SuffixTreeNode<Alphabet>* node) {
     if (node == nullptr) return; // Base case for recursion
 
-    for (size_t i = 0; i < MAX_CHAR; i++) {
-        if (node->children[i] != nullptr) {
-            freeSuffixTree(node->children[i]); 
-        }
-    }
+    node->children.for_each([](int, SuffixTreeNode<Alphabet>* child) {
+        freeSuffixTree(child); 
+    });
     delete node->end; 
     delete node; 
 }
 
 
-// Driver function
-
-int main() {
-
-    // Read the file content and add '$' termination character
-    char* input = readFile("Data.txt");
+// Build, measure and optionally print the suffix tree for one alphabet
+template <typename Alphabet>
+void runSuffixTree(char* input) {
 
     // Get the length of the input string
     int length = strlen(input);
+    std::cout << "Alphabet: " << Alphabet::name << std::endl;
     std::cout << "Number of characters in the string: " << length << std::endl;
 
     // Calculate and display the memory occupied by the input string in kilobytes
@@ -174,7 +210,7 @@ int main() {
 
     // Start measuring time for suffix tree construction
     auto start = std::chrono::high_resolution_clock::now();
-    SuffixTreeNode* root = buildSuffixTree(input);
+    SuffixTreeNode<Alphabet>* root = buildSuffixTree<Alphabet>(input);
     auto end = std::chrono::high_resolution_clock::now();
 
     // Calculate and display the time taken to construct the suffix tree
@@ -185,17 +221,38 @@ int main() {
     size_t memoryUsage = calculateMemoryUsage(root);
     std::cout << "Memory occupied by the suffix tree: " << memoryUsage / 1024.0 << " KB" << std::endl;
 
-    // Prompt user for printing the suffix tree
+    // Prompt user for printing or exporting the suffix tree
     int choice;
-    std::cout << "\nEnter 1 to print the suffix tree: ";
+    std::cout << "\nEnter 1 to print the suffix tree, 2 to export it as DOT, 3 as JSON lines, 4 as binary: ";
     std::cin >> choice;
     if (choice == 1) {
         std::cout << "Suffix Tree for the input file:" << std::endl;
         printSuffixTree(root, 0); // Print the suffix tree
+    } else if (choice >= 2 && choice <= 4) {
+        exportSuffixTree(root, static_cast<ExportFormat>(choice - 2)); // Export the suffix tree
     }
 
-    // Free memory allocated for suffix tree and input text
+    // Free memory allocated for suffix tree
     freeSuffixTree(root);
+}
+
+
+// Driver function
+
+int main() {
+
+    // Read the file content and add '$' termination character
+    char* input = readFile("Data.txt");
+
+    // Detect the alphabet once and run the tree code specialized for it
+    AlphabetKind kind = detect_alphabet(input);
+    if (kind == ALPHABET_BYTE) {
+        std::cout << "Note: the input has characters outside the DNA, IUPAC and protein alphabets, using the byte alphabet." << std::endl;
+    }
+    with_alphabet(kind, [input](auto alphabet) {
+        runSuffixTree<decltype(alphabet)>(input);
+    });
+
     free(input); // Free the input string
 
     return 0; 
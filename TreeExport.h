@@ -0,0 +1,173 @@
+// Iterative, buffered export of a suffix tree shared by the suffix tree builders (Naive and Ukkonen)
+// Edges are written as (start, length) references into the input string instead of copied labels,
+// through a large output buffer, in DOT, JSON lines or a compact binary format.
+
+#ifndef TREE_EXPORT_H
+#define TREE_EXPORT_H
+
+// std::to_chars is standard from C++17; do not rely on older modes exposing it as a library extension
+#if (defined(_MSVC_LANG) && _MSVC_LANG < 201703L) || (!defined(_MSVC_LANG) && __cplusplus < 201703L)
+#error "TreeExport.h requires C++17 (std::to_chars): compile with -std=c++17"
+#endif
+
+// C++ Libraries
+#include <charconv>  // For fast integer formatting
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <utility>
+#include <vector>
+
+// Size of the output buffer used while exporting
+#define EXPORT_BUFFER_SIZE (1 << 20)
+
+
+// Supported export formats
+enum ExportFormat { EXPORT_DOT, EXPORT_JSON, EXPORT_BINARY };
+
+// Default file name for each export format
+inline const char* export_file_name(ExportFormat format) {
+    switch (format) {
+        case EXPORT_DOT: return "SuffixTree.dot";
+        case EXPORT_JSON: return "SuffixTree.jsonl";
+        default: return "SuffixTree.bin";
+    }
+}
+
+
+// Writes the edges of a tree to a file through a fixed-size buffer
+//   DOT:        digraph with one "parent -> child [label=\"start,length\"]" line per edge
+//   JSON lines: one {"parent":..,"child":..,"start":..,"length":..} object per edge
+//   Binary:     "STE1" followed by one record of four little-endian int32 (parent, child, start, length) per edge,
+//               written byte by byte so the file reads the same on machines of either byte order
+class TreeExporter {
+    std::ofstream file;
+    ExportFormat format;
+    std::vector<char> buffer;
+    size_t used;
+    size_t total;
+    bool failed;  // Set once a write or the final close fails
+
+    // Write the buffered bytes to the file, counting them only if the write succeeds
+    void flush() {
+        if (!failed) {
+            if (file.write(buffer.data(), used)) total += used;
+            else failed = true;
+        }
+        used = 0;
+    }
+
+    void append(const char* data, size_t length) {
+        if (used + length > buffer.size()) flush();
+        memcpy(buffer.data() + used, data, length);
+        used += length;
+    }
+
+    void append(const char* text) { append(text, strlen(text)); }
+
+    void append_int(int value) {
+        if (used + 16 > buffer.size()) flush();
+        char* end = std::to_chars(buffer.data() + used, buffer.data() + buffer.size(), value).ptr;
+        used = end - buffer.data();
+    }
+
+    // Write a 32-bit integer as little-endian bytes
+    void append_le32(int32_t value) {
+        uint32_t bits = static_cast<uint32_t>(value);
+        char bytes[4];
+        for (int i = 0; i < 4; i++) bytes[i] = static_cast<char>((bits >> (8 * i)) & 0xff);
+        append(bytes, 4);
+    }
+
+public:
+    TreeExporter(const char* filename, ExportFormat format)
+        : file(filename, std::ios::binary), format(format), buffer(EXPORT_BUFFER_SIZE), used(0), total(0), failed(false) {}
+
+    ~TreeExporter() { finish(); }
+
+    bool is_open() const { return file.is_open(); }
+
+    // False if any part of the output could not be written (e.g. the disk is full)
+    bool ok() const { return !failed; }
+
+    // Total bytes written to the file so far
+    size_t bytes_written() const { return total; }
+
+    void begin() {
+        if (format == EXPORT_DOT) append("digraph SuffixTree {\n");
+        else if (format == EXPORT_BINARY) append("STE1", 4);
+    }
+
+    void edge(int parent, int child, int start, int length) {
+        switch (format) {
+            case EXPORT_DOT:
+                append("  ");
+                append_int(parent);
+                append(" -> ");
+                append_int(child);
+                append(" [label=\"");
+                append_int(start);
+                append(",");
+                append_int(length);
+                append("\"];\n");
+                break;
+            case EXPORT_JSON:
+                append("{\"parent\":");
+                append_int(parent);
+                append(",\"child\":");
+                append_int(child);
+                append(",\"start\":");
+                append_int(start);
+                append(",\"length\":");
+                append_int(length);
+                append("}\n");
+                break;
+            default:
+                append_le32(parent);
+                append_le32(child);
+                append_le32(start);
+                append_le32(length);
+                break;
+        }
+    }
+
+    void end() {
+        if (format == EXPORT_DOT) append("}\n");
+        finish();
+    }
+
+    // Flush the remaining output and close the file
+    void finish() {
+        if (!file.is_open()) return;
+        flush();
+        file.close();
+        if (file.fail()) failed = true;
+    }
+};
+
+
+// Export a tree without recursion: nodes wait on an explicit stack and are numbered in visiting order (root is 0)
+//   for_each_child(node, f) calls f(child) for every child of node
+//   edge_of(child) returns the (start, length) of the edge leading into child
+template <typename Node, typename ForEachChild, typename EdgeOf>
+void export_tree(TreeExporter &exporter, Node root, ForEachChild for_each_child, EdgeOf edge_of) {
+    std::vector<std::pair<Node, int>> stack;
+    int next_id = 1;
+
+    exporter.begin();
+    stack.push_back(std::make_pair(root, 0));
+    while (!stack.empty()) {
+        Node node = stack.back().first;
+        int id = stack.back().second;
+        stack.pop_back();
+
+        for_each_child(node, [&](Node child) {
+            std::pair<int, int> edge = edge_of(child);
+            exporter.edge(id, next_id, edge.first, edge.second);
+            stack.push_back(std::make_pair(child, next_id++));
+        });
+    }
+    exporter.end();
+}
+
+#endif
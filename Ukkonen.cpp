@@ -8,166 +8,173 @@
 #include <iostream>
 #include <fstream>
 #include <string>
+#include "Alphabet.h" // Alphabet policies and child storage
+#include "TreeExport.h" // Buffered DOT/JSON/binary export
 
 // Constants for buffer size and growth factor
 #define INITIAL_SIZE 2048 
 #define GROWTH_FACTOR 2 
-#define ALPHABET_SIZE 5 // A, T, G, C, and $
 
-//Global Variables and Constants
+//Global Constants
 const int oo = 1 << 25;  // Represents infinity
-int root, last_added, current_position, needSL, r, active_node, active_edge_index, active_length;
 
 using namespace std;
 
 // Node structure to represent a node in the suffix tree
+template <typename Alphabet>
 struct node {
     int start; //Start index of the edge
     int end;    // End index of the edge
     int suffix_link; // suffix link
-    vector<int> nextIndices;  // Dynamic array to store the next node pointers
+    Children<Alphabet, int> nextIndices;  // Child node indices, sized for the alphabet
 
     // Constructor to initialize the node
-    node() : nextIndices(ALPHABET_SIZE, 0), start(0), end(0), suffix_link(0) {}
-
-    // Calculate the length of the edge
-    int edge_length() {
-        return min(end, current_position + 1) - start;
-    }
+    node() : start(0), end(0), suffix_link(0) {}
 };
 
-// Global variables
-vector<node> tree;
-string input_string;
+// Suffix tree built with Ukkonen's algorithm, specialized for one alphabet
+template <typename Alphabet>
+struct SuffixTree {
+    int root, last_added, current_position, needSL, r, active_node, active_edge_index, active_length;
+    vector<node<Alphabet>> tree;
+    string input_string;
 
-// Function to map 'A', 'T', 'G', 'C', '$' to indices
-int char_to_index(char c) {
-    switch (c) {
-        case 'A': return 0;
-        case 'T': return 1;
-        case 'G': return 2;
-        case 'C': return 3;
-        case '$': return 4;  
-        default: return -1;
+    // Function to map a character to its child index
+    static int char_to_index(char c) {
+        return Alphabet::index[static_cast<unsigned char>(c)];
     }
-}
 
-// Function to initialize a new node
-int new_node(int start, int end = oo) {
-    node nd;
-    nd.start = start;
-    nd.end = end;
-    nd.suffix_link = 0;
-    tree.push_back(nd);  // Add the new node to the end of the tree vector
-    return ++last_added; 
-}
+    // Calculate the length of the edge leading into a node
+    int edge_length(int node) const {
+        return min(tree[node].end, current_position + 1) - tree[node].start;
+    }
 
-// Create a new leaf node
-char active_edge() {
-    return input_string[active_edge_index];
-}
+    // Function to initialize a new node
+    int new_node(int start, int end = oo) {
+        node<Alphabet> nd;
+        nd.start = start;
+        nd.end = end;
+        nd.suffix_link = 0;
+        tree.push_back(nd);  // Add the new node to the end of the tree vector
+        return ++last_added; 
+    }
 
-// Add a suffix link
-void add_SL(int node) {
-    if (needSL > 0) tree[needSL].suffix_link = node;
-    needSL = node;
-}
+    // Character at the start of the active edge
+    char active_edge() const {
+        return input_string[active_edge_index];
+    }
 
-// Check if we can move further down the tree from the given node
-bool walk_down(int node) {
-    if (active_length >= tree[node].edge_length()) {
-        active_edge_index += tree[node].edge_length();
-        active_length -= tree[node].edge_length();
-        active_node = node;
-        return true;
+    // Add a suffix link
+    void add_SL(int node) {
+        if (needSL > 0) tree[needSL].suffix_link = node;
+        needSL = node;
     }
-    return false;
-}
 
-// Initialize the suffix tree
-void st_init() {
-    needSL = 0;
-    last_added = -1;
-    current_position = -1;
-    r = 0;
-    active_node = 0;
-    active_edge_index = 0;
-    active_length = 0;
-    tree.clear();  
-    tree.reserve(2);
-    root = active_node = new_node(-1, -1);  // Initialize root node
-}
+    // Check if we can move further down the tree from the given node
+    bool walk_down(int node) {
+        if (active_length >= edge_length(node)) {
+            active_edge_index += edge_length(node);
+            active_length -= edge_length(node);
+            active_node = node;
+            return true;
+        }
+        return false;
+    }
 
-// Extension function for Ukkonen's algorithm to add characters to the suffix tree
-void extend_suffix_tree(char new_char) {
-    input_string += new_char;  // Add the new character to the input_string
-    current_position++;  
-    needSL = 0;  // Reset the suffix link necessity
-    r++;  // Increment the active extension count
+    // Initialize the suffix tree
+    void st_init() {
+        needSL = 0;
+        last_added = -1;
+        current_position = -1;
+        r = 0;
+        active_node = 0;
+        active_edge_index = 0;
+        active_length = 0;
+        tree.clear();  
+        tree.reserve(2);
+        input_string.clear();
+        root = active_node = new_node(-1, -1);  // Initialize root node
+    }
 
-    while (r > 0) {
-        if (active_length == 0) {
-            active_edge_index = current_position;  // Set active edge index
-        }
+    // Extension function for Ukkonen's algorithm to add characters to the suffix tree
+    void extend_suffix_tree(char new_char) {
+        input_string += new_char;  // Add the new character to the input_string
+        current_position++;  
+        needSL = 0;  // Reset the suffix link necessity
+        r++;  // Increment the active extension count
 
-        int edge_index = char_to_index(active_edge());
-        if (tree[active_node].nextIndices[edge_index] == 0) {
-            int leaf_node = new_node(current_position);  // Create a new leaf node
-            tree[active_node].nextIndices[edge_index] = leaf_node;  // Add leaf to the active node's children
-            add_SL(active_node); // Link the suffix
-        } else {
-            int next_node = tree[active_node].nextIndices[edge_index]; // Get the next node
-            if (walk_down(next_node)) continue; // If walked down, continue with the loop
-
-            if (input_string[tree[next_node].start + active_length] == new_char) {
-                active_length++;  // Increase the active length
-                add_SL(active_node); // Link the suffix
-                break;  // Exit the loop as the current character matched
+        while (r > 0) {
+            if (active_length == 0) {
+                active_edge_index = current_position;  // Set active edge index
             }
 
-            int split_node = new_node(tree[next_node].start, tree[next_node].start + active_length);
-            tree[active_node].nextIndices[edge_index] = split_node; // Update the active node's edge to the new split node
+            int edge_index = char_to_index(active_edge());
+            int next_node = tree[active_node].nextIndices.get(edge_index);
+            if (next_node == 0) {
+                int leaf_node = new_node(current_position);  // Create a new leaf node
+                tree[active_node].nextIndices.set(edge_index, leaf_node);  // Add leaf to the active node's children
+                add_SL(active_node); // Link the suffix
+            } else {
+                if (walk_down(next_node)) continue; // If walked down, continue with the loop
 
-            int new_leaf = new_node(current_position); // Create a new leaf for the current position
-            tree[split_node].nextIndices[char_to_index(new_char)] = new_leaf; // Add new leaf to the split node
+                if (input_string[tree[next_node].start + active_length] == new_char) {
+                    active_length++;  // Increase the active length
+                    add_SL(active_node); // Link the suffix
+                    break;  // Exit the loop as the current character matched
+                }
 
-            tree[next_node].start += active_length; // Update the existing edge
-            tree[split_node].nextIndices[char_to_index(input_string[tree[next_node].start])] = next_node;
+                int split_node = new_node(tree[next_node].start, tree[next_node].start + active_length);
+                tree[active_node].nextIndices.set(edge_index, split_node); // Update the active node's edge to the new split node
 
-            add_SL(split_node); // Link the suffix
-        }
-        r--; // Decrease the active extension count
+                int new_leaf = new_node(current_position); // Create a new leaf for the current position
+                tree[split_node].nextIndices.set(char_to_index(new_char), new_leaf); // Add new leaf to the split node
+
+                tree[next_node].start += active_length; // Update the existing edge
+                tree[split_node].nextIndices.set(char_to_index(input_string[tree[next_node].start]), next_node);
+
+                add_SL(split_node); // Link the suffix
+            }
+            r--; // Decrease the active extension count
 
-        if (active_node == root && active_length > 0) {
-            active_length--; // Decrease the active length
-            active_edge_index = current_position - r + 1; // Move to the next character
-        } else {
-            active_node = (tree[active_node].suffix_link > 0) ? tree[active_node].suffix_link : root; // Navigate suffix link or return to root
+            if (active_node == root && active_length > 0) {
+                active_length--; // Decrease the active length
+                active_edge_index = current_position - r + 1; // Move to the next character
+            } else {
+                active_node = (tree[active_node].suffix_link > 0) ? tree[active_node].suffix_link : root; // Navigate suffix link or return to root
+            }
         }
     }
-}
 
-// Function to calculate the space occupied by the suffix tree in bytes
-size_t calculate_space() {
-    size_t total_size = 0;
-    for (const auto& nd : tree) {
-        total_size += sizeof(nd.start) + sizeof(nd.end) + sizeof(nd.suffix_link); 
-        total_size += nd.nextIndices.capacity() * sizeof(int);  
+    // Function to calculate the space occupied by the suffix tree in bytes
+    size_t calculate_space() const {
+        size_t total_size = 0;
+        for (const auto& nd : tree) {
+            total_size += sizeof(nd.start) + sizeof(nd.end) + sizeof(nd.suffix_link); 
+            total_size += sizeof(nd.nextIndices) + nd.nextIndices.heap_bytes();  
+        }
+        return total_size;
     }
-    return total_size;
-}
 
-// Function to print the suffix tree
-void print_suffix_tree(int node, const string &input, const string &prefix) {
-    for (int i = 0; i < ALPHABET_SIZE; ++i) {
-        if (tree[node].nextIndices[i] > 0) {
-            int child = tree[node].nextIndices[i];
-            string edge = input.substr(tree[child].start, tree[child].edge_length());
+    // Function to print the suffix tree
+    void print_suffix_tree(int node, const string &input, const string &prefix) const {
+        tree[node].nextIndices.for_each([&](int, int child) {
+            string edge = input.substr(tree[child].start, edge_length(child));
             cout << prefix << edge << endl;  // Print the edge label
             print_suffix_tree(child, input, prefix + edge);  // Recursive call
-        }
+        });
     }
-}
+
+    // Function to export the suffix tree to a file without recursion, writing edges as (start, length) references
+    void export_suffix_tree(TreeExporter &exporter) const {
+        export_tree(exporter, root,
+            [this](int node, auto visit) {
+                tree[node].nextIndices.for_each([&visit](int, int child) { visit(child); });
+            },
+            [this](int child) {
+                return make_pair(tree[child].start, edge_length(child));
+            });
+    }
+};
 
 // Function to read the content of the file into a dynamically allocated string
 char* readFile(const char* filename) {
@@ -195,6 +202,11 @@ char* readFile(const char* filename) {
         }
     }
 
+    // Drop the trailing newline editors add, it is not part of the sequence
+    while (length > 0 && (buffer[length - 1] == '\n' || buffer[length - 1] == '\r')) {
+        length--;
+    }
+
     buffer[length] = '\0'; // Null-terminate the string
     file.close();
 
@@ -206,23 +218,21 @@ char* readFile(const char* filename) {
     return buffer; 
 }
 
-//Driver function
+// Build, measure and optionally print the suffix tree for one alphabet
+template <typename Alphabet>
+void run_suffix_tree(const string &input_str) {
+    SuffixTree<Alphabet> st;
 
-int main() {
-
-    // Read the input string from the file
-    char* input = readFile("Data.txt");
-    string input_str(input);  // Convert char* to string
-
-    // Print length of the string
-    std::cout << "\nLength of the input string (including terminal character): " << input_str.length() << std::endl;
+    // Print alphabet and length of the string
+    std::cout << "\nAlphabet: " << Alphabet::name << std::endl;
+    std::cout << "Length of the input string (including terminal character): " << input_str.length() << std::endl;
 
     // Measure time taken to construct the suffix tree
     auto start = std::chrono::high_resolution_clock::now();
-    st_init();  // Initialize the suffix tree
+    st.st_init();  // Initialize the suffix tree
     // Construct the suffix tree by passing each character to st_extend
     for (char c : input_str) {
-        extend_suffix_tree(c);
+        st.extend_suffix_tree(c);
     }
     auto end = std::chrono::high_resolution_clock::now();
     std::chrono::duration<double, std::milli> cpu_time_used = end - start;  
@@ -236,19 +246,57 @@ int main() {
     std::cout << "Time taken to construct suffix tree: " << cpu_time_used.count() << " ms" << std::endl;
 
     // Calculate and print the space taken by the suffix tree in bytes and kilobytes
-    size_t space_occupied = calculate_space();
+    size_t space_occupied = st.calculate_space();
     double space_occupied_kb = space_occupied / 1024.0;  
     std::cout << "Memory occupied by the suffix tree: "<< space_occupied_kb << " KB" << std::endl;
 
-    // Ask user if they want to print the suffix tree
+    // Ask user if they want to print or export the suffix tree
     int choice;
-    cout << "Enter 1 to print the suffix tree: ";
+    cout << "Enter 1 to print the suffix tree, 2 to export it as DOT, 3 as JSON lines, 4 as binary: ";
     cin >> choice;
 
     if (choice == 1) {
         cout << "Suffix Tree:" << endl;
-        print_suffix_tree(root, input_str, "");  // Print the suffix tree starting from the root
+        st.print_suffix_tree(st.root, input_str, "");  // Print the suffix tree starting from the root
+    } else if (choice >= 2 && choice <= 4) {
+        ExportFormat format = static_cast<ExportFormat>(choice - 2);
+        const char* filename = export_file_name(format);
+        TreeExporter exporter(filename, format);
+        if (!exporter.is_open()) {
+            std::cerr << "Error opening file." << std::endl; // Error handling
+            return;
+        }
+
+        // Measure time taken to export the tree
+        start = std::chrono::high_resolution_clock::now();
+        st.export_suffix_tree(exporter);
+        end = std::chrono::high_resolution_clock::now();
+        if (!exporter.ok()) {
+            std::cerr << "Error writing file." << std::endl; // Error handling
+            return;
+        }
+        cpu_time_used = end - start;
+        cout << "Suffix tree exported to " << filename << ": " << exporter.bytes_written() / 1024.0
+             << " KB in " << cpu_time_used.count() << " ms" << endl;
+    }
+}
+
+//Driver function
+
+int main() {
+
+    // Read the input string from the file
+    char* input = readFile("Data.txt");
+    string input_str(input);  // Convert char* to string
+
+    // Detect the alphabet once and run the tree code specialized for it
+    AlphabetKind kind = detect_alphabet(input);
+    if (kind == ALPHABET_BYTE) {
+        std::cout << "Note: the input has characters outside the DNA, IUPAC and protein alphabets, using the byte alphabet." << std::endl;
     }
+    with_alphabet(kind, [&input_str](auto alphabet) {
+        run_suffix_tree<decltype(alphabet)>(input_str);
+    });
 
     free(input);  // Free dynamically allocated memory
     return 0;